@@ -0,0 +1,335 @@
+//
+//  board.hpp
+//  SudokuSolver
+//
+//  Unit tables and brut force solving core on fixed size arrays and digit
+//  bit masks, usable both at runtime and at compile time (C++14 constexpr).
+//  Bit d of a mask stands for digit d. No allocation and no iostream in this
+//  header.
+//
+
+#ifndef board_hpp
+#define board_hpp
+
+#include <cstddef>
+#include <utility>
+
+typedef int INDEX;
+typedef int DIGIT;
+typedef std::pair<INDEX,DIGIT> CELL;
+
+// Solve result
+enum STATUS {SOLVED, UNSOLVABLE, OUT_OF_BUDGET};
+
+// Search budget usable at compile time: number of search nodes only
+class NodeBudget {
+
+private:
+  // Maximum number of nodes, 0 for unlimited
+  long maxNodes;
+
+public:
+  // Number of nodes spent
+  long nodes;
+  // Budget ran out
+  bool exhausted;
+
+public:
+  // Constructor, 0 means unlimited
+  constexpr NodeBudget(const long& _maxNodes = 0) : maxNodes(_maxNodes), nodes(0), exhausted(false) {}
+  // Count one search node
+  // return: Budget still available
+  constexpr bool spend() {
+    if (exhausted) return false;
+    ++nodes;
+    if (maxNodes>0 && nodes>maxNodes) exhausted = true;
+    return !exhausted;
+  }
+};
+
+// Units of 9 cells holding each digit once: lines, columns, squares and variant units
+class Units {
+
+public:
+  // Table size
+  enum {N = 9, NN = 81, MAX_UNITS = 36, MAX_CELL_UNITS = 6};
+  // Number of units
+  int count = 0;
+  // Cells of each unit
+  INDEX cells[MAX_UNITS][N] = {};
+  // Units of each cell
+  int cellUnitCount[NN] = {};
+  INDEX cellUnits[NN][MAX_CELL_UNITS] = {};
+  // Neighboring cells sharing at least one unit with each cell
+  int peerCount[NN] = {};
+  INDEX peers[NN][NN-1] = {};
+  // Number of cells shared by two units
+  int overlap[MAX_UNITS][MAX_UNITS] = {};
+  // Every unit has 9 distinct cells and the tables were large enough
+  bool valid = true;
+
+public:
+  // Constructor, no unit
+  constexpr Units() {}
+
+  // Add unit, call link() once all units are added
+  // unit: cell indices of the unit
+  // return: Boolean success
+  constexpr bool add(const INDEX (&unit)[N]) {
+    bool seen[NN] = {};
+    for (int i = 0; i<N; ++i) {
+      if (unit[i]<0 || unit[i]>=NN || seen[unit[i]] || cellUnitCount[unit[i]]==MAX_CELL_UNITS) valid = false;
+      else seen[unit[i]] = true;
+    }
+    if (!valid || count==MAX_UNITS) return valid = false;
+    for (int i = 0; i<N; ++i) {
+      cells[count][i] = unit[i];
+      cellUnits[unit[i]][cellUnitCount[unit[i]]++] = count;
+    }
+    ++count;
+    return true;
+  }
+  // Add the 9 lines, columns or squares
+  constexpr void addLines() {
+    for (INDEX l = 0; l<N; ++l) {
+      INDEX unit[N] = {};
+      for (int i = 0; i<N; ++i) unit[i] = N*l + i;
+      add(unit);
+    }
+  }
+  constexpr void addColumns() {
+    for (INDEX c = 0; c<N; ++c) {
+      INDEX unit[N] = {};
+      for (int i = 0; i<N; ++i) unit[i] = c + N*i;
+      add(unit);
+    }
+  }
+  constexpr void addSquares() {
+    for (INDEX s = 0; s<N; ++s) {
+      INDEX unit[N] = {};
+      for (int i = 0; i<N; ++i) unit[i] = 3*(s%3) + 27*(s/3) + (i%3) + N*(i/3);
+      add(unit);
+    }
+  }
+  // Compute peers and overlaps once all units are added
+  constexpr void link() {
+    for (INDEX c = 0; c<NN; ++c) {
+      bool seen[NN] = {};
+      seen[c] = true;
+      peerCount[c] = 0;
+      for (int u = 0; u<cellUnitCount[c]; ++u) {
+        for (int i = 0; i<N; ++i) {
+          auto p = cells[cellUnits[c][u]][i];
+          if (seen[p]) continue;
+          seen[p] = true;
+          peers[c][peerCount[c]++] = p;
+        }
+        for (int v = 0; v<cellUnitCount[c]; ++v) {
+          if (v!=u) ++overlap[cellUnits[c][u]][cellUnits[c][v]];
+        }
+      }
+    }
+  }
+
+  // Classic layout: lines, columns and 3x3 squares
+  static constexpr Units classic() {
+    Units units;
+    units.addLines();
+    units.addColumns();
+    units.addSquares();
+    units.link();
+    return units;
+  }
+  // X-Sudoku: classic layout and both main diagonals
+  static constexpr Units diagonal() {
+    Units units;
+    units.addLines();
+    units.addColumns();
+    units.addSquares();
+    INDEX main[N] = {}, anti[N] = {};
+    for (int i = 0; i<N; ++i) {
+      main[i] = (N+1)*i;
+      anti[i] = (N-1)*(i+1);
+    }
+    units.add(main);
+    units.add(anti);
+    units.link();
+    return units;
+  }
+  // Windoku: classic layout and four 3x3 windows with corners at lines and columns 1 and 5
+  static constexpr Units windoku() {
+    Units units;
+    units.addLines();
+    units.addColumns();
+    units.addSquares();
+    for (int w = 0; w<4; ++w) {
+      INDEX unit[N] = {};
+      auto corner = N*(1+4*(w/2)) + 1+4*(w%2);
+      for (int i = 0; i<N; ++i) unit[i] = corner + (i%3) + N*(i/3);
+      units.add(unit);
+    }
+    units.link();
+    return units;
+  }
+  // Jigsaw: lines, columns and 9 irregular regions
+  // regions: region number 0-8 of each cell, each region must have 9 cells
+  static constexpr Units jigsaw(const INDEX (&regions)[NN]) {
+    Units units;
+    units.addLines();
+    units.addColumns();
+    for (INDEX r = 0; r<N; ++r) {
+      INDEX unit[N] = {};
+      int size(0);
+      for (INDEX c = 0; c<NN; ++c) {
+        if (regions[c]!=r) continue;
+        if (size<N) unit[size] = c;
+        ++size;
+      }
+      if (size==N) units.add(unit);
+      else units.valid = false;
+    }
+    units.link();
+    return units;
+  }
+};
+
+// Predefined layouts, classic is shared by default
+static constexpr Units CLASSIC_UNITS = Units::classic();
+static constexpr Units DIAGONAL_UNITS = Units::diagonal();
+static constexpr Units WINDOKU_UNITS = Units::windoku();
+
+class Board {
+
+public:
+  // Board size
+  enum {N = Units::N, NN = Units::NN, ALL_DIGITS = 0x3FE};
+  // Digit of cells, 0 for empty
+  DIGIT cells[NN] = {};
+
+private:
+  // Unit tables
+  const Units* units;
+  // Masks of digits used per unit
+  int digits[Units::MAX_UNITS] = {};
+  // No conflict between filled cells
+  bool valid = true;
+
+public:
+  // Constructor, empty board
+  // _units: unit tables, must outlive the board
+  constexpr Board(const Units& _units = CLASSIC_UNITS) : units(&_units), valid(_units.valid) {}
+  // Constructor
+  // input: list of filled cells
+  // _units: unit tables, must outlive the board
+  template <size_t K>
+  constexpr Board(const CELL (&input)[K], const Units& _units = CLASSIC_UNITS) : units(&_units), valid(_units.valid) {
+    for (size_t i = 0; i<K; ++i) {
+      if (!place(input[i].first, input[i].second)) valid = false;
+    }
+  }
+
+  // Helper to count digits in a mask
+  static constexpr int countDigits(int mask) {
+    int count(0);
+    for (; mask; mask &= mask-1) ++count;
+    return count;
+  }
+
+  // Get possible digits of an empty cell
+  // cell: Current cell index
+  // return: Mask of digits not used in the units of the cell
+  constexpr int getCandidates(const INDEX& cell) const {
+    int used(0);
+    for (int u = 0; u<units->cellUnitCount[cell]; ++u) {
+      used |= digits[units->cellUnits[cell][u]];
+    }
+    return ALL_DIGITS & ~used;
+  }
+  // Place digit in empty cell
+  // cell: Current cell index
+  // value: Digit to place
+  // return: Digit was not used in the units of the cell
+  constexpr bool place(const INDEX& cell, const DIGIT& value) {
+    auto bit = 1<<value;
+    auto free = (getCandidates(cell) & bit)!=0;
+    cells[cell] = value;
+    for (int u = 0; u<units->cellUnitCount[cell]; ++u) {
+      digits[units->cellUnits[cell][u]] |= bit;
+    }
+    return free;
+  }
+  // Erase digit placed by a successful place()
+  // cell: Current cell index
+  constexpr void erase(const INDEX& cell) {
+    auto bit = 1<<cells[cell];
+    cells[cell] = 0;
+    for (int u = 0; u<units->cellUnitCount[cell]; ++u) {
+      digits[units->cellUnits[cell][u]] &= ~bit;
+    }
+  }
+  // Get unit tables
+  constexpr const Units& getUnits() const {
+    return *units;
+  }
+  // Check if all cells are filled without conflict
+  constexpr bool isSolved() const {
+    if (!valid) return false;
+    for (INDEX i = 0; i<NN; ++i) {
+      if (!cells[i]) return false;
+    }
+    return true;
+  }
+
+  // Solve Brut Force within budget
+  // budget: Search budget providing spend() and exhausted, on exhaustion the board is left unchanged.
+  //         Deduced as its concrete type since spend() is not virtual, do not pass a Budget as NodeBudget&
+  // return: Solve status
+  template <class BUDGET>
+  constexpr STATUS solve(BUDGET& budget) {
+    if (!valid) return UNSOLVABLE;
+    if (search(budget)) return SOLVED;
+    return budget.exhausted ? OUT_OF_BUDGET : UNSOLVABLE;
+  }
+  // Solve Brut Force at compile time
+  // input: list of filled cells
+  // units: unit tables, must outlive the board
+  // return: Solved board, or the input board if there is no solution
+  template <size_t K>
+  static constexpr Board solved(const CELL (&input)[K], const Units& units = CLASSIC_UNITS) {
+    Board board(input, units);
+    NodeBudget budget;
+    board.solve(budget);
+    return board;
+  }
+
+private:
+  // Depth first search on the empty cell with fewest possible digits
+  // budget: Search budget
+  // return: Found a solution, the board is restored otherwise
+  template <class BUDGET>
+  constexpr bool search(BUDGET& budget) {
+    if (!budget.spend()) return false;
+    INDEX cell(-1);
+    int count(N+1);
+    for (INDEX i = 0; i<NN && count>1; ++i) {
+      if (cells[i]) continue;
+      auto c = countDigits(getCandidates(i));
+      if (c<count) {
+        cell = i;
+        count = c;
+      }
+    }
+    if (cell<0) return true;
+    auto candidates = getCandidates(cell);
+    for (DIGIT value = 1; value<=N; ++value) {
+      if (!((candidates>>value) & 1)) continue;
+      place(cell, value);
+      if (search(budget)) return true;
+      erase(cell);
+      if (budget.exhausted) return false;
+    }
+    return false;
+  }
+};
+
+#endif /* board_hpp */
@@ -0,0 +1,47 @@
+//
+//  client.cpp
+//  SudokuSolver
+//
+//  Send puzzles read from stdin, one per line, to the solver daemon and
+//  print one response per line. The line "STATS" queries daemon statistics.
+//  Usage: client [-s socket]
+//
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include "protocol.hpp"
+
+int main(int argc, const char * argv[]) {
+  
+  std::string path = DEFAULT_SOCKET_PATH;
+  if (argc==3 && !std::strcmp(argv[1], "-s")) path = argv[2];
+  else if (argc!=1) {
+    std::cerr << "Usage: " << argv[0] << " [-s socket]" << std::endl;
+    return 1;
+  }
+  
+  std::signal(SIGPIPE, SIG_IGN);
+  auto fd = connectUnix(path);
+  if (fd<0) {
+    std::cerr << "Cannot connect to " << path << ": " << std::strerror(errno) << std::endl;
+    return 1;
+  }
+  
+  std::string buffer, request, response;
+  while (std::getline(std::cin, request)) {
+    if (request.empty()) continue;
+    if (!writeAll(fd, request + '\n') || !readLine(fd, buffer, response)) {
+      std::cerr << "Connection closed" << std::endl;
+      close(fd);
+      return 1;
+    }
+    std::cout << response << std::endl;
+  }
+  close(fd);
+  
+  return 0;
+}
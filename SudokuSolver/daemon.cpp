@@ -0,0 +1,66 @@
+//
+//  daemon.cpp
+//  SudokuSolver
+//
+//  Resident solver serving puzzles over a Unix socket.
+//  Usage: daemon [-s socket] [-t threads] [-b batch] [-m human|brut] [-n nodes] [-T timeout_us] [-u classic|diagonal|windoku]
+//
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <csignal>
+#include <thread>
+#include "server.hpp"
+#include "protocol.hpp"
+
+static Server* server = nullptr;
+
+// Signal handler stopping the server
+static void onSignal(int) {
+  if (server) server->stop();
+}
+
+int main(int argc, const char * argv[]) {
+  
+  std::string path = DEFAULT_SOCKET_PATH;
+  int threads = std::max(1u, std::thread::hardware_concurrency());
+  size_t batch = 16;
+  auto method = Server::HUMAN_STYLE;
+  long nodes = 0;
+  long timeout = 0;
+  auto units = &CLASSIC_UNITS;
+  for (int i = 1; i+1<argc; i += 2) {
+    if (!std::strcmp(argv[i], "-s")) path = argv[i+1];
+    else if (!std::strcmp(argv[i], "-t")) threads = std::atoi(argv[i+1]);
+    else if (!std::strcmp(argv[i], "-b")) batch = std::atoi(argv[i+1]);
+    else if (!std::strcmp(argv[i], "-m")) method = std::strcmp(argv[i+1], "brut") ? Server::HUMAN_STYLE : Server::BRUT_FORCE;
+    else if (!std::strcmp(argv[i], "-n")) nodes = std::atol(argv[i+1]);
+    else if (!std::strcmp(argv[i], "-T")) timeout = std::atol(argv[i+1]);
+    else if (!std::strcmp(argv[i], "-u") && !std::strcmp(argv[i+1], "diagonal")) units = &DIAGONAL_UNITS;
+    else if (!std::strcmp(argv[i], "-u") && !std::strcmp(argv[i+1], "windoku")) units = &WINDOKU_UNITS;
+    else if (!std::strcmp(argv[i], "-u") && !std::strcmp(argv[i+1], "classic")) units = &CLASSIC_UNITS;
+    else {
+      std::cerr << "Usage: " << argv[0] << " [-s socket] [-t threads] [-b batch] [-m human|brut] [-n nodes] [-T timeout_us] [-u classic|diagonal|windoku]" << std::endl;
+      return 1;
+    }
+  }
+  
+  Server instance(path, threads, batch, method, nodes, std::chrono::microseconds(timeout), *units);
+  server = &instance;
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+  std::signal(SIGPIPE, SIG_IGN);
+  
+  std::cerr << "Listening on " << path << " with " << threads << " solver threads" << std::endl;
+  if (!instance.run()) {
+    std::cerr << "Cannot listen on " << path << ": " << std::strerror(errno) << std::endl;
+    return 1;
+  }
+  std::cerr << instance.stats() << std::endl;
+  server = nullptr;
+  
+  return 0;
+}
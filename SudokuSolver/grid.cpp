@@ -8,56 +8,55 @@
 
 #include "grid.hpp"
 #include <algorithm>
+#include <cassert>
+
+// Constructor, unlimited budget
+Budget::Budget() : NodeBudget(0), hasDeadline(false) {}
+
+// Constructor
+// _maxNodes: maximum number of search nodes, 0 for unlimited
+// timeout: wall-clock time from now, 0 for unlimited
+Budget::Budget(const long& _maxNodes, const std::chrono::microseconds& timeout)
+: NodeBudget(_maxNodes), hasDeadline(timeout.count()>0), deadline(CLOCK::now()+timeout) {}
+
+// Constructor with absolute deadline
+// _maxNodes: maximum number of search nodes, 0 for unlimited
+// _deadline: wall-clock deadline, e.g. arrival time of a request plus its timeout
+Budget::Budget(const long& _maxNodes, const CLOCK::time_point& _deadline)
+: NodeBudget(_maxNodes), hasDeadline(true), deadline(_deadline) {}
+
+// Count one search node, a deduction step or a guess
+// return: Budget still available
+bool Budget::spend() {
+  if (!NodeBudget::spend()) return false;
+  if (hasDeadline && nodes%CHECK_PERIOD==0 && CLOCK::now()>deadline) exhausted = true;
+  return !exhausted;
+}
+
+// Check deadline on every call, for steps too expensive to amortize the clock read
+// return: Budget still available
+bool Budget::check() {
+  if (!exhausted && hasDeadline && CLOCK::now()>deadline) exhausted = true;
+  return !exhausted;
+}
 
 // Constructor
 // input: list of filled cells in the grid
-Grid::Grid(const FILLED_CELLS& input) {
-  std::cout << "Initialization: " << std::endl;
-  // Initialize empty grid
-  SET_DIGITS emptyCell = {1,2,3,4,5,6,7,8,9};
+// _verbose: print initialization and check messages to terminal
+// _units: unit tables, must outlive the grid
+Grid::Grid(const FILLED_CELLS& input, const bool& _verbose, const Units& _units) : units(&_units), verbose(_verbose) {
+  reset(input);
+}
+
+// Constructor from board
+// board: filled cells of the board, e.g. a solution computed at compile time
+// _verbose: print initialization and check messages to terminal
+Grid::Grid(const Board& board, const bool& _verbose) : units(&board.getUnits()), verbose(_verbose) {
+  FILLED_CELLS input;
   for (INDEX i = 0; i<NN; ++i) {
-    data[i] = emptyCell;
-    remainingCells.insert(i);
-  }
-  for (INDEX i = 0; i<N; ++i) {
-    remainingLines[i] = getLineIndicesFromLine(i);
-    remainingColumns[i] = getColumnIndicesFromColumn(i);
-    remainingSquares[i] = getSquareIndicesFromSquare(i);
-  }
-  // Update input
-  for (const auto& cell : input) {
-    auto index = cell.first;
-    auto value = cell.second;
-    data[index] = {value};
-    auto it = remainingCells.find(index);
-    if (it!=remainingCells.end()) {
-      remainingCells.erase(it);
-      solvedCells.insert(index);
-    }
-    else assert(false);
-    auto& rl = remainingLines[getLineIndexFromCell(index)];
-    auto it_l = std::find(rl.begin(), rl.end(), index);
-    if (it_l!=rl.end()) {
-      rl.erase(it_l);
-    }
-    else assert(false);
-    auto& rc = remainingColumns[getColumnIndexFromCell(index)];
-    auto it_c = std::find(rc.begin(), rc.end(), index);
-    if (it_c!=rc.end()) {
-      rc.erase(it_c);
-    }
-    else assert(false);
-    auto& rs = remainingSquares[getSquareIndexFromCell(index)];
-    auto it_s = std::find(rs.begin(), rs.end(), index);
-    if (it_s!=rs.end()) {
-      rs.erase(it_s);
-    }
-    else assert(false);
+    if (board.cells[i]) input[i] = board.cells[i];
   }
-  // Check data
-  clean();
-  isValid = check();
-  if (isValid) print();
+  reset(input);
 }
 
 // Copy constructor
@@ -74,65 +73,57 @@ Grid& Grid::operator=(const Grid& _grid) {
   }
   remainingCells = _grid.remainingCells;
   solvedCells = _grid.solvedCells;
-  for (INDEX i = 0; i<N; ++i) {
-    remainingLines[i] = _grid.remainingLines[i];
-    remainingColumns[i] = _grid.remainingColumns[i];
-    remainingSquares[i] = _grid.remainingSquares[i];
+  units = _grid.units;
+  for (INDEX i = 0; i<units->count; ++i) {
+    remainingUnits[i] = _grid.remainingUnits[i];
   }
+  brokenCells = _grid.brokenCells;
   isValid = _grid.isValid;
+  verbose = _grid.verbose;
   return *this;
 }
 
-// Helper to get the line indices
-// cell: Current cell index
-// return: List of all cell indices on the current line
-INDICES Grid::getLineIndicesFromCell(const INDEX& cell) {
-  return getLineIndicesFromLine(getLineIndexFromCell(cell));
-}
-INDEX Grid::getLineIndexFromCell(const INDEX& cell) {
-  return cell / 9;
-}
-INDICES Grid::getLineIndicesFromLine(const INDEX& shift) {
-  INDICES line = {0,1,2,3,4,5,6,7,8};
-  for (auto& ind : line) {
-    ind += 9*shift;
+// Reset grid to new input, keeping the unit tables and the capacity of the remaining unit lists,
+// the cell sets are rebuilt
+// input: list of filled cells in the grid
+void Grid::reset(const FILLED_CELLS& input) {
+  if (verbose) std::cout << "Initialization: " << std::endl;
+  // Initialize empty grid
+  static const SET_DIGITS emptyCell = {1,2,3,4,5,6,7,8,9};
+  remainingCells.clear();
+  solvedCells.clear();
+  for (INDEX i = 0; i<NN; ++i) {
+    data[i] = emptyCell;
+    remainingCells.insert(i);
+  }
+  for (INDEX i = 0; i<units->count; ++i) {
+    remainingUnits[i].assign(units->cells[i], units->cells[i]+N);
+  }
+  // Update input
+  for (const auto& cell : input) {
+    data[cell.first] = {cell.second};
+    markSolved(cell.first);
   }
-  return line;
+  // Check data
+  clean();
+  // Invalid unit tables, e.g. jigsaw with a region not of 9 cells, have no solution as in Board
+  isValid = units->valid && check();
+  updateBroken();
+  if (isValid && verbose) print();
 }
 
-// Helper to get the column indices
-// cell: Current cell index
-// return: List of all cell indices on the current column
-INDICES Grid::getColumnIndicesFromCell(const INDEX& cell) {
-  return getColumnIndicesFromColumn(getColumnIndexFromCell(cell));
-}
-INDEX Grid::getColumnIndexFromCell(const INDEX& cell) {
-  return cell % 9;
-}
-INDICES Grid::getColumnIndicesFromColumn(const INDEX& shift) {
-  INDICES column = {0,9,18,27,36,45,54,63,72};
-  for (auto& ind : column) {
-    ind += shift;
-  }
-  return column;
+// Helper to get the unit indices
+// unit: Current unit index
+// return: List of all cell indices of the unit
+INDICES Grid::getUnitIndices(const INDEX& unit) {
+  return INDICES(units->cells[unit], units->cells[unit]+N);
 }
 
-// Helper to get the square indices
+// Helper to get the neighboring indices
 // cell: Current cell index
-// return: List of all cell indices on the current square
-INDICES Grid::getSquareIndicesFromCell(const INDEX& cell) {
-  return getSquareIndicesFromSquare(getSquareIndexFromCell(cell));
-}
-INDEX Grid::getSquareIndexFromCell(const INDEX& cell) {
-  return ((cell % 9)/3) + 3*((cell / 9)/3);
-}
-INDICES Grid::getSquareIndicesFromSquare(const INDEX& index) {
-  auto shift = 3*(index%3) + 27*(index/3);
-  INDICES square = {0,1,2,9,10,11,18,19,20};
-  for (auto& ind : square) {
-    ind += shift;
-  }
-  return square;
+// return: List of all cell indices sharing a unit with the current cell, excluding current cell
+INDICES Grid::getPeerIndicesFromCell(const INDEX& cell) {
+  return INDICES(units->peers[cell], units->peers[cell]+units->peerCount[cell]);
 }
 
 // Helper to get factorial of n
@@ -176,19 +167,12 @@ std::vector<INDICES> Grid::getIndicesPermSizeKinN(const int& k, const int& n) {
   return permList;
 }
 
-// Clean value from indices in neighboring cell of current line, column and square
+// Clean value from indices in neighboring cell of current units
 // index: Current cell index
 // value: Digit to be removed from cells data
 void Grid::clean(const INDEX& index, const DIGIT& value) {
-  auto lineIndices = getLineIndicesFromCell(index);
-  auto columnIndices = getColumnIndicesFromCell(index);
-  auto squareIndices = getSquareIndicesFromCell(index);
-  SET_INDICES indices;
-  indices.insert(lineIndices.begin(), lineIndices.end());
-  indices.insert(columnIndices.begin(), columnIndices.end());
-  indices.insert(squareIndices.begin(), squareIndices.end());
-  for (const auto& ind : indices) {
-    if (ind==index || data[ind].size()==1) continue;
+  for (const auto& ind : getPeerIndicesFromCell(index)) {
+    if (data[ind].size()==1) continue;
     auto it = data[ind].find(value);
     if (it != data[ind].end()) {
       data[ind].erase(it);
@@ -250,45 +234,99 @@ bool Grid::check(const INDEX& index, const DIGIT& value, const INDICES& indices)
 // value: Digit to check
 // return: Boolean success
 bool Grid::check(const INDEX& index, const DIGIT& value) {
-  if (!check(index,value,getLineIndicesFromCell(index))) return false;
-  if (!check(index,value,getColumnIndicesFromCell(index))) return false;
-  if (!check(index,value,getSquareIndicesFromCell(index))) return false;
-  return true;
+  return check(index,value,getPeerIndicesFromCell(index));
 }
 
-// Set solved cell
+// Move cell from remaining to solved bookkeeping
 // index: Current cell index
-// value: Digit to assign
-void Grid::setSolvedCell(const INDEX& index, const DIGIT& value) {
-  data[index] = {value};
+void Grid::markSolved(const INDEX& index) {
   auto it = remainingCells.find(index);
   if (it!=remainingCells.end()) {
     remainingCells.erase(it);
     solvedCells.insert(index);
   }
   else assert(false);
-  auto& rl = remainingLines[getLineIndexFromCell(index)];
-  auto it_l = std::find(rl.begin(), rl.end(), index);
-  if (it_l!=rl.end()) {
-    rl.erase(it_l);
+  for (int u = 0; u<units->cellUnitCount[index]; ++u) {
+    auto& ru = remainingUnits[units->cellUnits[index][u]];
+    auto it_u = std::find(ru.begin(), ru.end(), index);
+    if (it_u!=ru.end()) {
+      ru.erase(it_u);
+    }
+    else assert(false);
   }
-  else assert(false);
-  auto& rc = remainingColumns[getColumnIndexFromCell(index)];
-  auto it_c = std::find(rc.begin(), rc.end(), index);
-  if (it_c!=rc.end()) {
-    rc.erase(it_c);
+}
+
+// Move cell from solved to remaining bookkeeping, remaining indices stay sorted
+// index: Current cell index
+void Grid::markRemaining(const INDEX& index) {
+  auto it = solvedCells.find(index);
+  if (it!=solvedCells.end()) {
+    solvedCells.erase(it);
+    remainingCells.insert(index);
   }
   else assert(false);
-  auto& rs = remainingSquares[getSquareIndexFromCell(index)];
-  auto it_s = std::find(rs.begin(), rs.end(), index);
-  if (it_s!=rs.end()) {
-    rs.erase(it_s);
+  for (int u = 0; u<units->cellUnitCount[index]; ++u) {
+    auto& ru = remainingUnits[units->cellUnits[index][u]];
+    ru.insert(std::lower_bound(ru.begin(), ru.end(), index), index);
   }
-  else assert(false);
+}
+
+// Set solved cell
+// index: Current cell index
+// value: Digit to assign
+void Grid::setSolvedCell(const INDEX& index, const DIGIT& value) {
+  data[index] = {value};
+  markSolved(index);
   clean(index, value);
   isValid = std::min(isValid, check(index, value));
 }
 
+// Get digits of solved neighboring cells
+// cell: Current cell index
+// return: Bit mask with bit d set if digit d is solved in a neighboring cell
+int Grid::getSolvedPeerDigits(const INDEX& cell) {
+  int digits(0);
+  for (int p = 0; p<units->peerCount[cell]; ++p) {
+    auto ind = units->peers[cell][p];
+    if (solvedCells.count(ind)) digits |= 1<<*data[ind].begin();
+  }
+  return digits;
+}
+
+// Check if cell breaks the position
+// cell: Current cell index
+// return: Solved cell with a neighboring cell solved to the same digit,
+//         or remaining cell whose digits are all solved in neighboring cells
+bool Grid::isBroken(const INDEX& cell) {
+  auto digits = getSolvedPeerDigits(cell);
+  if (solvedCells.count(cell)) return (digits>>*data[cell].begin()) & 1;
+  for (const auto& value : data[cell]) {
+    if (!((digits>>value) & 1)) return false;
+  }
+  return true;
+}
+
+// Update broken cells around an edited cell
+// index: Edited cell index
+void Grid::updateBroken(const INDEX& index) {
+  auto indices = getPeerIndicesFromCell(index);
+  indices.push_back(index);
+  for (const auto& ind : indices) {
+    if (isBroken(ind)) brokenCells.insert(ind);
+    else brokenCells.erase(ind);
+  }
+  isValid = units->valid && brokenCells.empty();
+}
+
+// Rebuild broken cells of the whole grid, after reset or solve
+void Grid::updateBroken() {
+  brokenCells.clear();
+  for (INDEX i = 0; i<NN; ++i) {
+    if (isBroken(i)) brokenCells.insert(i);
+  }
+  isValid = units->valid && brokenCells.empty();
+}
+
 // Solve unique value in neighboring indices
 // index: Current cell index
 // value: Digit to check if unique in neighboring indices, if so clean()
@@ -307,9 +345,9 @@ bool Grid::unique(const INDEX& index, const DIGIT& value, const INDICES& indices
   return true;
 }
 
-// Solve linked square with neighboring indices
-// squareIndices: Indices of current square
-// indices: Indices of neighboring line or column
+// Solve linked square with overlapping unit indices
+// squareIndices: Indices of current square, or any unit
+// indices: Indices of an overlapping line, column or unit
 // return: Found a linked cells that need to be cleaned
 bool Grid::linkedSquares(const INDICES& squareIndices, const INDICES& indices) {
   INDICES remainingSquareIndices;
@@ -366,8 +404,9 @@ bool Grid::linkedSquares(const INDICES& squareIndices, const INDICES& indices) {
 
 // Solve linked cells in neighboring indices
 // remainingIndices: Indices of remaining cell
+// budget: Search budget, deadline checked per permutation
 // return: Found a linked cells that need to be cleaned
-bool Grid::linkedCells(const INDICES& remainingIndices) {
+bool Grid::linkedCells(const INDICES& remainingIndices, Budget& budget) {
   auto nr = (int)remainingIndices.size();
   auto checkLinkedPerm = [&] (INDICES cellPerm, INDICES cellPermCompl) -> bool {
     SET_DIGITS valuesInCellPerm;
@@ -386,6 +425,7 @@ bool Grid::linkedCells(const INDICES& remainingIndices) {
   for (INDEX k = 2; k <= ((nr+1)/2); ++k) {
     auto perms = getIndicesPermSizeKinN(k, nr);
     for (auto perm : perms) {
+      if (!budget.check()) return false;
       INDICES cellPerm;
       cellPerm.reserve(perm.size());
       for (const auto& i : perm) {
@@ -403,6 +443,16 @@ bool Grid::linkedCells(const INDICES& remainingIndices) {
   return false;
 }
 
+// Get solved cells of the grid
+// return: Map of cell index to digit for every cell with a single digit left
+FILLED_CELLS Grid::getFilledCells() {
+  FILLED_CELLS cells;
+  for (INDEX i = 0; i<NN; ++i) {
+    if (data[i].size()==1) cells[i] = *data[i].begin();
+  }
+  return cells;
+}
+
 // Print grid to terminal
 void Grid::print() {
   for (INDEX i = 0; i<NN; ++i) {
@@ -429,7 +479,7 @@ void Grid::clean() {
 // Check if Grid is valid
 // return: Boolean success
 bool Grid::check() {
-  std::cout << "Check: ";
+  if (verbose) std::cout << "Check: ";
   bool success(true);
   for (const auto& cell : solvedCells) {
     assert(data[cell].size()==1);
@@ -437,7 +487,7 @@ bool Grid::check() {
     success = check(cell,value);
     if (success==false) break;
   }
-  std::cout << (success ? "true" : "false") << std::endl;
+  if (verbose) std::cout << (success ? "true" : "false") << std::endl;
   return success;
 }
 
@@ -459,97 +509,190 @@ bool Grid::last() {
   return false;
 }
 
-// Solve unique value per lines, columns, squares
+// Solve unique value per units
 // return: Found a unique value for cell at index
 bool Grid::unique() {
   for (const auto cell : remainingCells) {
     for (const auto value : data[cell]) {
-      if (unique(cell,value,getLineIndicesFromCell(cell))) return true;
-      if (unique(cell,value,getColumnIndicesFromCell(cell))) return true;
-      if (unique(cell,value,getSquareIndicesFromCell(cell))) return true;
+      for (int u = 0; u<units->cellUnitCount[cell]; ++u) {
+        if (unique(cell,value,getUnitIndices(units->cellUnits[cell][u]))) return true;
+      }
     }
   }
   return false;
 }
 
-// Solve linked squares
+// Solve linked squares, generalized to any two units sharing more than one cell
 // return: Found a linked square that need to be cleaned
 bool Grid::linkedSquares() {
   for (const auto cell : remainingCells) {
-    if (linkedSquares(getSquareIndicesFromCell(cell),getLineIndicesFromCell(cell))) return true;
-    if (linkedSquares(getSquareIndicesFromCell(cell),getColumnIndicesFromCell(cell))) return true;
+    const auto& cellUnits = units->cellUnits[cell];
+    for (int v = 1; v<units->cellUnitCount[cell]; ++v) {
+      for (int u = 0; u<v; ++u) {
+        if (units->overlap[cellUnits[u]][cellUnits[v]]<2) continue;
+        if (linkedSquares(getUnitIndices(cellUnits[v]),getUnitIndices(cellUnits[u]))) return true;
+      }
+    }
   }
   return false;
 }
 
-// Solve linked cells per lines, columns, squares
+// Solve linked cells per units
 // return: Found a linked cells that need to be cleaned
 bool Grid::linkedCells() {
-  for (const auto& remainingline : remainingLines) {
-    if (remainingline.size()>2) {
-      if (linkedCells(remainingline)) return true;
-    }
-  }
-  for (const auto& remainingColumn : remainingColumns) {
-    if (remainingColumn.size()>2) {
-      if (linkedCells(remainingColumn)) return true;
-    }
-  }
-  for (const auto& remainingSquare : remainingSquares) {
-    if (remainingSquare.size()>2) {
-      if (linkedCells(remainingSquare)) return true;
+  Budget budget;
+  return linkedCells(budget);
+}
+
+// Solve linked cells per units within budget
+// budget: Search budget, deadline checked per permutation
+// return: Found a linked cells that need to be cleaned
+bool Grid::linkedCells(Budget& budget) {
+  for (INDEX u = 0; u<units->count; ++u) {
+    if (remainingUnits[u].size()>2) {
+      if (linkedCells(remainingUnits[u], budget)) return true;
+      if (budget.exhausted) return false;
     }
   }
   return false;
 }
 
+// Place digit in cell, replacing any digit already there
+// index: Current cell index
+// value: Digit to place
+// return: Position is still solvable, see isSolvable(), false for an index or digit out of range
+bool Grid::place(const INDEX& index, const DIGIT& value) {
+  if (index<0 || index>=NN || value<1 || value>N) return false;
+  if (solvedCells.count(index)) erase(index);
+  data[index] = {value};
+  markSolved(index);
+  for (const auto& ind : getPeerIndicesFromCell(index)) {
+    if (!solvedCells.count(ind)) data[ind].erase(value);
+  }
+  updateBroken(index);
+  return isSolvable();
+}
+
+// Erase digit from cell, restoring the digits it had eliminated
+// index: Current cell index
+// return: Position is still solvable, see isSolvable(), false for an index out of range
+bool Grid::erase(const INDEX& index) {
+  if (index<0 || index>=NN) return false;
+  if (!solvedCells.count(index)) return isSolvable();
+  auto value = *data[index].begin();
+  markRemaining(index);
+  auto digits = getSolvedPeerDigits(index);
+  data[index].clear();
+  for (DIGIT d = 1; d<=N; ++d) {
+    if (!((digits>>d) & 1)) data[index].insert(d);
+  }
+  for (const auto& ind : getPeerIndicesFromCell(index)) {
+    if (solvedCells.count(ind)) continue;
+    if (!((getSolvedPeerDigits(ind)>>value) & 1)) data[ind].insert(value);
+  }
+  updateBroken(index);
+  return isSolvable();
+}
+
+// Check if position has no conflict and no dead cell
+// Cheap necessary condition maintained by place() and erase() and rebuilt after each solve,
+// a full answer needs a solve. Exact for pure edit sequences only: erase() does not restore
+// digits removed by the deductions of a solve, so a remaining cell may look dead afterwards.
+// return: Valid unit tables, no solved cells in conflict and every remaining cell has a possible digit
+bool Grid::isSolvable() {
+  return units->valid && brokenCells.empty();
+}
+
+// Get remaining digits of a cell
+// cell: Current cell index
+// return: Digits still possible in the cell
+SET_DIGITS Grid::getCandidates(const INDEX& cell) {
+  return data[cell];
+}
+
+// Get solve status
+// budget: Budget used by the last solve
+// return: SOLVED, OUT_OF_BUDGET if the budget ran out first, UNSOLVABLE otherwise
+STATUS Grid::getStatus(const Budget& budget) {
+  if (countRemaining()==0 && isValid) return SOLVED;
+  return budget.exhausted ? OUT_OF_BUDGET : UNSOLVABLE;
+}
+
 // Solve Human Style
 void Grid::solveHumanStyle() {
-  if (!isValid) return;
+  Budget budget;
+  solveHumanStyle(budget);
+}
+
+// Solve Human Style within budget
+// budget: Search budget, on exhaustion the grid is left with the deductions made before the first guess
+// return: Solve status
+STATUS Grid::solveHumanStyle(Budget& budget) {
+  auto status = searchHumanStyle(budget);
+  // Deductions may leave conflicts, keep isSolvable() and later edits in sync
+  updateBroken();
+  return status;
+}
+
+// Search Human Style, recursion of solveHumanStyle
+// budget: Search budget
+// return: Solve status
+STATUS Grid::searchHumanStyle(Budget& budget) {
+  if (!isValid) return getStatus(budget);
   // REMARK force to stop after founding the first solution
   while (countRemaining()>0) {
+    // Deduction steps are expensive, read the clock on every step
+    if (!budget.spend() || !budget.check()) return getStatus(budget);
     // Solvers which set a single cell
     if (last()) continue;
-    if (!isValid) return;
+    if (!isValid) return getStatus(budget);
     if (unique()) continue;
-    if (!isValid) return;
+    if (!isValid) return getStatus(budget);
     // Solvers which clean some cells data
     if (linkedSquares()) continue;
-    if (linkedCells()) continue;
+    if (linkedCells(budget)) continue;
+    if (budget.exhausted) return getStatus(budget);
     // Recursion
     auto initialGrid = Grid(*this);
     for (const auto& cell : initialGrid.remainingCells) {
       auto initialCellData = data[cell];
       for (const auto& value : initialCellData) {
         setSolvedCell(cell, value);
-        solveHumanStyle();
+        searchHumanStyle(budget);
         // REMARK force to stop after founding the first solution
-        if (remainingCells.size()==0) return;
+        if (remainingCells.size()==0 && isValid) return SOLVED;
         *this = initialGrid;
+        if (budget.exhausted) return OUT_OF_BUDGET;
       }
     }
     break;
   }
+  return getStatus(budget);
 }
 
 // Solve Brut Force
 void Grid::solveBrutForce() {
-  if (!isValid) return;
-  for (INDEX cell = 0; cell<NN; ++cell) {
-    if (data[cell].size()>1) {
-      for (DIGIT value = 1; value<=9; ++value) {
-        if (check(cell, value)) {
-          auto cellData = data[cell];
-          data[cell] = {value};
-          solveBrutForce();
-          // REMARK force to stop after founding the first solution
-          if (remainingCells.size()==0) return;
-          data[cell] = cellData;
-        }
-      }
-      return;
+  Budget budget;
+  solveBrutForce(budget);
+}
+
+// Solve Brut Force within budget, shares the constexpr search of Board
+// budget: Search budget, on exhaustion the grid is left unchanged
+// return: Solve status
+STATUS Grid::solveBrutForce(Budget& budget) {
+  if (!isValid) return getStatus(budget);
+  Board board(*units);
+  for (const auto& cell : solvedCells) {
+    board.place(cell, *data[cell].begin());
+  }
+  if (board.solve(budget)==SOLVED) {
+    // Copy since remainingCells is modified in the loop
+    auto cells = remainingCells;
+    for (const auto& cell : cells) {
+      data[cell] = {board.cells[cell]};
+      markSolved(cell);
     }
   }
-  // REMARK force to stop after founding the first solution
-  remainingCells.clear();
+  updateBroken();
+  return getStatus(budget);
 }
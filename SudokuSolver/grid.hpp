@@ -16,14 +16,40 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <chrono>
+#include "board.hpp"
 
-typedef int INDEX;
 typedef std::vector<INDEX> INDICES;
 typedef std::set<INDEX> SET_INDICES;
-typedef int DIGIT;
 typedef std::vector<DIGIT> DIGITS;
 typedef std::set<DIGIT> SET_DIGITS;
 typedef std::map<INDEX,DIGIT> FILLED_CELLS;
+typedef std::chrono::steady_clock CLOCK;
+
+// Search budget: NodeBudget node count and/or wall-clock deadline
+// spend() hides the non-virtual NodeBudget::spend(), pass a Budget by its own type: through a
+// NodeBudget& only the node count is checked
+class Budget : public NodeBudget {
+  
+private:
+  // Clock is read once every CHECK_PERIOD nodes by spend(), on every call by check()
+  enum {CHECK_PERIOD = 32};
+  // Deadline, if any
+  bool hasDeadline;
+  CLOCK::time_point deadline;
+  
+public:
+  // Constructor, unlimited budget
+  Budget();
+  // Constructor, 0 means unlimited
+  Budget(const long& _maxNodes, const std::chrono::microseconds& timeout);
+  // Constructor with absolute deadline
+  Budget(const long& _maxNodes, const CLOCK::time_point& _deadline);
+  // Count one search node
+  bool spend();
+  // Check deadline
+  bool check();
+};
 
 class Grid {
   
@@ -36,41 +62,37 @@ private:
   SET_INDICES remainingCells;
   // Solved cell indices;
   SET_INDICES solvedCells;
-  // Remaing line indices
-  INDICES remainingLines[N];
-  // Remaing column indices
-  INDICES remainingColumns[N];
-  // Remaing squares indices
-  INDICES remainingSquares[N];
+  // Unit tables: lines, columns, squares and variant units
+  const Units* units;
+  // Remaing unit indices
+  INDICES remainingUnits[Units::MAX_UNITS];
+  // Cells breaking the position: solved cells in conflict, remaining cells without a possible digit
+  SET_INDICES brokenCells;
   // Is valid
   bool isValid;
+  // Print initialization and check messages to terminal
+  bool verbose;
   
 public:
   // Constructor
-  Grid(const FILLED_CELLS& input);
+  Grid(const FILLED_CELLS& input, const bool& _verbose = true, const Units& _units = CLASSIC_UNITS);
+  // Constructor from board
+  Grid(const Board& board, const bool& _verbose = true);
   // Copy constructor
   Grid(const Grid& _grid);
   // Assignement operator
   Grid& operator=(const Grid& _grid);
   
 private:
-  // Helper to get the line indices
-  INDICES getLineIndicesFromCell(const INDEX& cell);
-  INDEX   getLineIndexFromCell(const INDEX& cell);
-  INDICES getLineIndicesFromLine(const INDEX& shift);
-  // Helper to get the column indices
-  INDICES getColumnIndicesFromCell(const INDEX& cell);
-  INDEX   getColumnIndexFromCell(const INDEX& cell);
-  INDICES getColumnIndicesFromColumn(const INDEX& shift);
-  // Helper to get the square indices
-  INDICES getSquareIndicesFromCell(const INDEX& cell);
-  INDEX   getSquareIndexFromCell(const INDEX& cell);
-  INDICES getSquareIndicesFromSquare(const INDEX& shift);
+  // Helper to get the unit indices
+  INDICES getUnitIndices(const INDEX& unit);
+  // Helper to get the neighboring indices sharing a unit
+  INDICES getPeerIndicesFromCell(const INDEX& cell);
   // Helper to get factorial of n
   int factorial(const int& n);
   // Helper to get indices permutations
   std::vector<INDICES> getIndicesPermSizeKinN(const int& k, const int& n);
-  // Clean value from indices in neighboring cell of current line, column and square
+  // Clean value from indices in neighboring cell of current units
   void clean(const INDEX& index, const DIGIT& value);
   // Clean value from indices
   int clean(const INDICES& indices, const DIGIT& value);
@@ -80,16 +102,34 @@ private:
   bool check(const INDEX& index, const DIGIT& value, const INDICES& indices);
   // Check if value is present in neighboring indices
   bool check(const INDEX& index, const DIGIT& value);
+  // Move cell from remaining to solved bookkeeping
+  void markSolved(const INDEX& index);
+  // Move cell from solved to remaining bookkeeping
+  void markRemaining(const INDEX& index);
   // Set solved cell
   void setSolvedCell(const INDEX& index, const DIGIT& value);
+  // Get digits of solved neighboring cells as bit mask
+  int getSolvedPeerDigits(const INDEX& cell);
+  // Check if cell breaks the position
+  bool isBroken(const INDEX& cell);
+  // Update broken cells around an edited cell
+  void updateBroken(const INDEX& index);
+  // Rebuild broken cells of the whole grid
+  void updateBroken();
+  // Search Human Style, recursion of solveHumanStyle
+  STATUS searchHumanStyle(Budget& budget);
   // Solve unique value in neighboring indices
   bool unique(const INDEX& index, const DIGIT& value, const INDICES& indices);
-  // Solve linked squares with neighboring indices
+  // Solve linked squares with overlapping unit indices
   bool linkedSquares(const INDICES& squareIndices, const INDICES& indices);
   // Solve linked cells in neighboring indices
-  bool linkedCells(const INDICES& remainingIndices);
+  bool linkedCells(const INDICES& remainingIndices, Budget& budget);
   
 public:
+  // Reset grid to new input, keeping the unit tables and remaining unit list capacity
+  void reset(const FILLED_CELLS& input);
+  // Get solved cells of the grid
+  FILLED_CELLS getFilledCells();
   // Print grid to terminal
   void print();
   // Clean grid
@@ -100,20 +140,33 @@ public:
   int  countRemaining();
   // Solve last value remaining in cell
   bool last();
-  // Solve unique value per lines, columns, squares
+  // Solve unique value per units
   bool unique();
   // Solve linked squares
   bool linkedSquares();
-  // Solve linked cells per lines, columns, squares
+  // Solve linked cells per units
   bool linkedCells();
+  bool linkedCells(Budget& budget);
+  // Place digit in cell
+  bool place(const INDEX& index, const DIGIT& value);
+  // Erase digit from cell
+  bool erase(const INDEX& index);
+  // Check if position has no conflict and no dead cell
+  bool isSolvable();
+  // Get remaining digits of a cell
+  SET_DIGITS getCandidates(const INDEX& cell);
+  // Get solve status
+  STATUS getStatus(const Budget& budget);
   // Solve Human Style
   void solveHumanStyle();
+  STATUS solveHumanStyle(Budget& budget);
   // Solve Brut Force
   void solveBrutForce();
+  STATUS solveBrutForce(Budget& budget);
 };
 
 // Grid example easy
-static FILLED_CELLS easy = {
+static constexpr CELL easyCells[] = {
   {1, 4}, {5, 7}, {6, 1},
   {9, 5}, {10, 3}, {13, 9}, {16, 7},
   {20, 7}, {22, 6}, {24, 9}, {25, 4},
@@ -124,9 +177,11 @@ static FILLED_CELLS easy = {
   {63, 3}, {64, 7}, {67, 5}, {68, 1},
   {72, 1}, {75, 2}, {77, 9}, {78, 3}, {79, 6}, {80, 7}
 };
+static constexpr Board easySolution = Board::solved(easyCells);
+static_assert(easySolution.isSolved(), "easy grid has no solution");
 
 // Grid example medium
-static FILLED_CELLS medium = {
+static constexpr CELL mediumCells[] = {
   {6, 4}, {7, 7},
   {9, 5}, {12, 4}, {17, 2},
   {19, 6}, {25, 3}, {26, 8},
@@ -137,9 +192,11 @@ static FILLED_CELLS medium = {
   {64, 4}, {65, 9}, {69, 7},
   {72, 8}, {73, 7}, {76, 2}, {80, 5}
 };
+static constexpr Board mediumSolution = Board::solved(mediumCells);
+static_assert(mediumSolution.isSolved(), "medium grid has no solution");
 
 // Grid example hard
-static FILLED_CELLS hard = {
+static constexpr CELL hardCells[] = {
   {1, 4}, {2, 9}, {8, 5},
   {12, 8}, {13, 3}, {14, 1},
   {26, 8},
@@ -150,9 +207,11 @@ static FILLED_CELLS hard = {
   {63, 2}, {64, 9}, {65, 4}, {66, 7},
   {72, 6}, {75, 9}
 };
+static constexpr Board hardSolution = Board::solved(hardCells);
+static_assert(hardSolution.isSolved(), "hard grid has no solution");
 
 // Grid example expert
-static FILLED_CELLS expert = {
+static constexpr CELL expertCells[] = {
   {2, 6}, {4, 4}, {7, 3},
   {10, 3}, {15, 6}, {17, 9},
   {21, 1}, {22, 3}, {24, 8},
@@ -163,5 +222,7 @@ static FILLED_CELLS expert = {
   {64, 6},
   {72, 4}, {79, 5}
 };
+static constexpr Board expertSolution = Board::solved(expertCells);
+static_assert(expertSolution.isSolved(), "expert grid has no solution");
 
 #endif /* grid_hpp */
@@ -0,0 +1,113 @@
+//
+//  loadgen.cpp
+//  SudokuSolver
+//
+//  Load generator for the solver daemon. Every connection sends the bundled
+//  grids round robin, depth requests pipelined at a time, and the end-to-end
+//  latency of each request is measured from its send to its response.
+//  Usage: loadgen [-s socket] [-c connections] [-n requests] [-d depth]
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+#include <unistd.h>
+#include "protocol.hpp"
+
+// Format a bundled grid as a request line
+// cells: list of filled cells
+// return: 81 characters, '.' for empty cells
+template <size_t K>
+static std::string formatCells(const CELL (&cells)[K]) {
+  return formatCells(FILLED_CELLS(std::begin(cells), std::end(cells)));
+}
+
+int main(int argc, const char * argv[]) {
+  
+  std::string path = DEFAULT_SOCKET_PATH;
+  int connections = 4;
+  int requests = 1000;
+  int depth = 1;
+  for (int i = 1; i+1<argc; i += 2) {
+    if (!std::strcmp(argv[i], "-s")) path = argv[i+1];
+    else if (!std::strcmp(argv[i], "-c")) connections = std::max(1, std::atoi(argv[i+1]));
+    else if (!std::strcmp(argv[i], "-n")) requests = std::max(1, std::atoi(argv[i+1]));
+    else if (!std::strcmp(argv[i], "-d")) depth = std::max(1, std::atoi(argv[i+1]));
+    else {
+      std::cerr << "Usage: " << argv[0] << " [-s socket] [-c connections] [-n requests] [-d depth]" << std::endl;
+      return 1;
+    }
+  }
+  
+  std::signal(SIGPIPE, SIG_IGN);
+  std::vector<std::string> puzzles = {formatCells(easyCells), formatCells(mediumCells), formatCells(hardCells), formatCells(expertCells)};
+  std::vector<std::vector<double>> latencies(connections);
+  std::vector<int> failures(connections, 0);
+  std::vector<std::thread> workers;
+  
+  auto start = CLOCK::now();
+  for (int c = 0; c<connections; ++c) {
+    workers.emplace_back([&, c] {
+      auto fd = connectUnix(path);
+      if (fd<0) {
+        failures[c] = requests;
+        return;
+      }
+      std::string buffer, response;
+      int sent(0);
+      while (sent<requests) {
+        auto count = std::min(depth, requests-sent);
+        std::string output;
+        for (int i = 0; i<count; ++i) output += puzzles[(sent+i)%puzzles.size()] + '\n';
+        auto begin = CLOCK::now();
+        if (!writeAll(fd, output)) {
+          failures[c] += requests-sent;
+          close(fd);
+          return;
+        }
+        for (int i = 0; i<count; ++i) {
+          if (!readLine(fd, buffer, response)) {
+            failures[c] += requests-sent;
+            close(fd);
+            return;
+          }
+          latencies[c].push_back(std::chrono::duration<double, std::micro>(CLOCK::now()-begin).count());
+          if (response.compare(0, 3, "OK ")!=0) failures[c]++;
+        }
+        sent += count;
+      }
+      close(fd);
+    });
+  }
+  for (auto& worker : workers) worker.join();
+  auto elapsed = std::chrono::duration<double>(CLOCK::now()-start).count();
+  
+  std::vector<double> all;
+  int failed(0);
+  for (int c = 0; c<connections; ++c) {
+    all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+    failed += failures[c];
+  }
+  if (all.empty()) {
+    std::cerr << "No response from " << path << std::endl;
+    return 1;
+  }
+  std::sort(all.begin(), all.end());
+  double total(0);
+  for (const auto& latency : all) total += latency;
+  auto at = [&all] (const double& p) { return all[std::min(all.size()-1, (size_t)(p*all.size()))]; };
+  
+  std::cout << "Requests: " << all.size() << " failed: " << failed << std::endl;
+  std::cout << "Throughput: " << all.size()/elapsed << " [requests/second]" << std::endl;
+  std::cout << "Latency mean: " << total/all.size() << " p50: " << at(0.5) << " p90: " << at(0.9);
+  std::cout << " p99: " << at(0.99) << " max: " << all.back() << " [microseconds]" << std::endl;
+  
+  return 0;
+}
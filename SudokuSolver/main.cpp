@@ -8,11 +8,13 @@
 
 #include <iostream>
 #include <chrono>
+#include <iterator>
 #include "grid.hpp"
 
 int main(int argc, const char * argv[]) {
   
-  auto level = expert; // easy, medium, hard, expert
+  FILLED_CELLS level(std::begin(expertCells), std::end(expertCells)); // easyCells, mediumCells, hardCells, expertCells
+  auto levelSolution = expertSolution; // Solved at compile time
   
   auto grid = Grid(level);
   auto start = std::chrono::high_resolution_clock::now();
@@ -20,10 +22,11 @@ int main(int argc, const char * argv[]) {
   auto stop = std::chrono::high_resolution_clock::now();
   auto solveTime = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
   
+  // REMARK expert has several solutions, brut force may print another one than human style
   std::cout << "Solution Brut Force: " << std::endl;
   grid.check();
   grid.print();
-  std::cout << "Solve time Brut Force: " << (float)solveTime.count()/1e6 << " [seconds]" << std::endl << std::endl; //About 0.49s
+  std::cout << "Solve time Brut Force: " << (float)solveTime.count()/1e6 << " [seconds]" << std::endl << std::endl; //About 40us, fewest candidates first
   
   grid = Grid(level);
   start = std::chrono::high_resolution_clock::now();
@@ -34,7 +37,12 @@ int main(int argc, const char * argv[]) {
   std::cout << "Solution Human Style: " << std::endl;
   grid.check();
   grid.print();
-  std::cout << "Solve time Human Style: " << (float)solveTime.count()/1e6 << " [seconds]" << std::endl << std::endl; //About 0.048s
+  std::cout << "Solve time Human Style: " << (float)solveTime.count()/1e6 << " [seconds]" << std::endl << std::endl; //About 1.2ms
+  
+  std::cout << "Solution Compile Time: " << std::endl;
+  grid = Grid(levelSolution, false);
+  grid.print();
+  std::cout << std::endl;
   
   return 0;
 }
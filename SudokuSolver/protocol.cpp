@@ -0,0 +1,148 @@
+//
+//  protocol.cpp
+//  SudokuSolver
+//
+
+#include "protocol.hpp"
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// macOS has no MSG_NOSIGNAL, callers ignore SIGPIPE instead
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// Parse a request line into filled cells
+// line: 81 characters, '1'-'9' filled, '0' or '.' empty, trailing whitespace ignored
+// cells: output filled cells
+// return: Boolean success
+bool parseCells(const std::string& line, FILLED_CELLS& cells) {
+  auto size = line.find_last_not_of(" \t\r") + 1;
+  if (size!=81) return false;
+  cells.clear();
+  for (INDEX i = 0; i<81; ++i) {
+    auto c = line[i];
+    if (c=='0' || c=='.') continue;
+    if (c<'1' || c>'9') return false;
+    cells[i] = c-'0';
+  }
+  return true;
+}
+
+// Format filled cells as a request or response line body
+// cells: filled cells
+// return: 81 characters, '.' for empty cells
+std::string formatCells(const FILLED_CELLS& cells) {
+  std::string line(81, '.');
+  for (const auto& cell : cells) {
+    line[cell.first] = (char)('0'+cell.second);
+  }
+  return line;
+}
+
+// Helper to fill a Unix socket address
+// path: socket path
+// address: output address
+// return: Boolean success
+static bool makeAddress(const std::string& path, sockaddr_un& address) {
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size()>=sizeof(address.sun_path)) return false;
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path)-1);
+  return true;
+}
+
+// Open a listening Unix socket, any stale socket file is replaced
+// path: socket path
+// return: file descriptor or -1
+int listenUnix(const std::string& path) {
+  sockaddr_un address;
+  if (!makeAddress(path, address)) return -1;
+  auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd<0) return -1;
+  unlink(path.c_str());
+  if (bind(fd, (sockaddr*)&address, sizeof(address))<0 || listen(fd, SOMAXCONN)<0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Connect to a Unix socket
+// path: socket path
+// return: file descriptor or -1
+int connectUnix(const std::string& path) {
+  sockaddr_un address;
+  if (!makeAddress(path, address)) return -1;
+  auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd<0) return -1;
+  if (connect(fd, (sockaddr*)&address, sizeof(address))<0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Helper to read once from fd into buffer
+// return: false on end of stream or error
+static bool readSome(const int& fd, std::string& buffer) {
+  char chunk[4096];
+  ssize_t count;
+  do {
+    count = read(fd, chunk, sizeof(chunk));
+  } while (count<0 && errno==EINTR);
+  if (count<=0) return false;
+  buffer.append(chunk, count);
+  return true;
+}
+
+// Read the next line from fd
+// buffer: unread bytes kept between calls
+// line: output line without the newline
+// return: false on end of stream, error or a line longer than MAX_LINE_LENGTH
+bool readLine(const int& fd, std::string& buffer, std::string& line) {
+  auto end = buffer.find('\n');
+  while (end==std::string::npos) {
+    if (buffer.size()>MAX_LINE_LENGTH || !readSome(fd, buffer)) return false;
+    end = buffer.find('\n');
+  }
+  line = buffer.substr(0, end);
+  buffer.erase(0, end+1);
+  return true;
+}
+
+// Read once from fd and extract all complete lines
+// buffer: unread bytes kept between calls
+// lines: output lines without the newline, cleared first
+// return: false on end of stream, error or a line longer than MAX_LINE_LENGTH
+bool readLines(const int& fd, std::string& buffer, std::vector<std::string>& lines) {
+  lines.clear();
+  if (!readSome(fd, buffer)) return false;
+  size_t start(0);
+  auto end = buffer.find('\n');
+  while (end!=std::string::npos) {
+    lines.push_back(buffer.substr(start, end-start));
+    start = end+1;
+    end = buffer.find('\n', start);
+  }
+  buffer.erase(0, start);
+  // Bound the memory held for a client that never sends a newline
+  return buffer.size()<=MAX_LINE_LENGTH;
+}
+
+// Write the whole string to fd
+// text: bytes to write
+// return: Boolean success
+bool writeAll(const int& fd, const std::string& text) {
+  size_t done(0);
+  while (done<text.size()) {
+    auto count = send(fd, text.data()+done, text.size()-done, MSG_NOSIGNAL);
+    if (count<0 && errno==EINTR) continue;
+    if (count<=0) return false;
+    done += count;
+  }
+  return true;
+}
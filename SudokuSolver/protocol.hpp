@@ -0,0 +1,44 @@
+//
+//  protocol.hpp
+//  SudokuSolver
+//
+//  Line protocol shared by the solver daemon, client and load generator.
+//
+//  Request:  one line of 81 characters, '1'-'9' for filled cells and
+//            '0' or '.' for empty cells, or the line "STATS".
+//  Response: "OK <81 chars>"    solved grid
+//            "FAIL <81 chars>"  no solution found, partially solved grid
+//            "TIMEOUT <81 chars>" budget exhausted, partially solved grid
+//            "ERR <message>"    malformed request
+//            "STATS <key=value ...>"
+//  A line longer than MAX_LINE_LENGTH closes the connection.
+//
+
+#ifndef protocol_hpp
+#define protocol_hpp
+
+#include <string>
+#include "grid.hpp"
+
+// Default socket path of the solver daemon
+static const char* const DEFAULT_SOCKET_PATH = "/tmp/sudokusolver.sock";
+// Longest line accepted by readLine and readLines, requests and responses are much shorter
+static const size_t MAX_LINE_LENGTH = 1024;
+
+// Parse a request line into filled cells
+bool parseCells(const std::string& line, FILLED_CELLS& cells);
+// Format filled cells as a request or response line body
+std::string formatCells(const FILLED_CELLS& cells);
+
+// Open a listening Unix socket, return file descriptor or -1
+int listenUnix(const std::string& path);
+// Connect to a Unix socket, return file descriptor or -1
+int connectUnix(const std::string& path);
+// Read the next line from fd, buffer keeps unread bytes between calls, false on a line too long
+bool readLine(const int& fd, std::string& buffer, std::string& line);
+// Read once from fd and extract all complete lines, buffer keeps the rest, false on a line too long
+bool readLines(const int& fd, std::string& buffer, std::vector<std::string>& lines);
+// Write the whole string to fd
+bool writeAll(const int& fd, const std::string& text);
+
+#endif /* protocol_hpp */
@@ -0,0 +1,216 @@
+//
+//  server.cpp
+//  SudokuSolver
+//
+
+#include "server.hpp"
+#include "protocol.hpp"
+#include <sstream>
+#include <algorithm>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+// Constructor
+// _path: Unix socket path
+// threads: number of solver threads
+// _batchSize: maximum number of jobs popped by a solver thread at once
+// _method: solving method
+// _maxNodes: search node budget per puzzle, 0 for unlimited
+// _timeout: solve time budget per puzzle, 0 for unlimited
+// _units: unit tables of the puzzles, must outlive the server
+Server::Server(const std::string& _path, const int& threads, const size_t& _batchSize, const Method& _method,
+               const long& _maxNodes, const std::chrono::microseconds& _timeout, const Units& _units)
+: path(_path), listenFd(-1), method(_method), units(&_units), maxNodes(_maxNodes), timeout(_timeout),
+  batchSize(std::max<size_t>(_batchSize, 1)), stopping(false), running(false),
+  solvedCount(0), failedCount(0), timeoutCount(0), batchCount(0), totalLatency(0), maxLatency(0) {
+  for (auto& bucket : latencies) bucket = 0;
+  solvers.reserve(std::max(threads, 1));
+  for (int i = 0; i<std::max(threads, 1); ++i) {
+    solvers.emplace_back([this] { solve(); });
+  }
+}
+
+// Destructor
+Server::~Server() {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stopping = true;
+  }
+  queueReady.notify_all();
+  for (auto& solver : solvers) solver.join();
+}
+
+// Accept connections until stop() is called
+// return: Boolean success of opening the socket
+bool Server::run() {
+  listenFd = listenUnix(path);
+  if (listenFd<0) return false;
+  startTime = CLOCK::now();
+  running = true;
+  while (running) {
+    // Poll with a timeout so that stop() needs no wake up
+    pollfd pfd = {listenFd, POLLIN, 0};
+    if (poll(&pfd, 1, 100)<=0) continue;
+    auto fd = accept(listenFd, nullptr, nullptr);
+    if (fd<0) continue;
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    connections.insert(fd);
+    std::thread([this, fd] { serve(fd); }).detach();
+  }
+  close(listenFd);
+  unlink(path.c_str());
+  // Wake up connection threads blocked in read and wait for them
+  std::unique_lock<std::mutex> lock(connectionsMutex);
+  for (const auto& fd : connections) shutdown(fd, SHUT_RDWR);
+  connectionsClosed.wait(lock, [this] { return connections.empty(); });
+  return true;
+}
+
+// Request run() to return, safe to call from a signal handler
+void Server::stop() {
+  running = false;
+}
+
+// Statistics line
+// return: "STATS" followed by key=value pairs, latencies in microseconds
+std::string Server::stats() {
+  auto solved = solvedCount.load();
+  auto failed = failedCount.load();
+  auto timedOut = timeoutCount.load();
+  auto count = solved+failed+timedOut;
+  auto elapsed = std::chrono::duration<double>(CLOCK::now()-startTime).count();
+  std::ostringstream line;
+  line << "STATS solved=" << solved << " failed=" << failed << " timeout=" << timedOut;
+  line << " batches=" << batchCount.load();
+  line << " throughput=" << (elapsed>0 ? count/elapsed : 0.) << "/s";
+  line << " mean_us=" << (count>0 ? totalLatency.load()/count : 0);
+  line << " p50_us=" << percentile(0.5) << " p99_us=" << percentile(0.99);
+  line << " max_us=" << maxLatency.load();
+  return line.str();
+}
+
+// Serve requests of one connection
+// fd: connection socket, closed on return
+void Server::serve(const int fd) {
+  std::string buffer;
+  std::vector<std::string> lines;
+  std::vector<Job> jobs;
+  Batch batch;
+  while (readLines(fd, buffer, lines)) {
+    if (lines.empty()) continue;
+    // Answer commands and malformed lines directly, queue the puzzles
+    auto arrival = CLOCK::now();
+    batch.responses.assign(lines.size(), std::string());
+    jobs.clear();
+    for (size_t i = 0; i<lines.size(); ++i) {
+      Job job = {FILLED_CELLS(), &batch, i, arrival};
+      if (lines[i].compare(0, 5, "STATS")==0) {
+        batch.responses[i] = stats();
+      }
+      else if (parseCells(lines[i], job.input)) {
+        jobs.push_back(job);
+      }
+      else {
+        batch.responses[i] = "ERR expected 81 characters of 0-9 or .";
+      }
+    }
+    batch.pending = (int)jobs.size();
+    if (!jobs.empty()) {
+      {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.insert(queue.end(), jobs.begin(), jobs.end());
+      }
+      if (jobs.size()==1) queueReady.notify_one();
+      else queueReady.notify_all();
+      batchCount++;
+      std::unique_lock<std::mutex> lock(batch.mutex);
+      batch.done.wait(lock, [&batch] { return batch.pending==0; });
+    }
+    std::string output;
+    for (const auto& response : batch.responses) {
+      output += response;
+      output += '\n';
+    }
+    if (!writeAll(fd, output)) break;
+  }
+  // Close under the lock so accept() cannot reuse fd while it is still tracked
+  std::lock_guard<std::mutex> lock(connectionsMutex);
+  connections.erase(fd);
+  close(fd);
+  connectionsClosed.notify_all();
+}
+
+// Solver thread loop, pops up to batchSize jobs per lock
+void Server::solve() {
+  // Scratch grid reset for each job, saving the Grid construction
+  Grid scratch(FILLED_CELLS(), false, *units);
+  std::vector<Job> jobs;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(queueMutex);
+      queueReady.wait(lock, [this] { return !queue.empty() || stopping; });
+      if (stopping) return;
+      auto count = std::min(batchSize, queue.size());
+      jobs.assign(queue.begin(), queue.begin()+count);
+      queue.erase(queue.begin(), queue.begin()+count);
+    }
+    for (const auto& job : jobs) {
+      auto response = solve(scratch, job.input, job.arrival);
+      record(job.arrival);
+      std::lock_guard<std::mutex> lock(job.batch->mutex);
+      job.batch->responses[job.slot] = std::move(response);
+      if (--job.batch->pending==0) job.batch->done.notify_one();
+    }
+  }
+}
+
+// Solve one puzzle with the scratch grid of the solver thread
+// scratch: grid reset to the input
+// input: filled cells of the puzzle
+// arrival: time the job was read from the connection, the timeout counts from there
+// return: response line
+std::string Server::solve(Grid& scratch, const FILLED_CELLS& input, const CLOCK::time_point& arrival) {
+  scratch.reset(input);
+  auto budget = timeout.count()>0 ? Budget(maxNodes, arrival+timeout) : Budget(maxNodes, timeout);
+  auto status = method==BRUT_FORCE ? scratch.solveBrutForce(budget) : scratch.solveHumanStyle(budget);
+  auto cells = formatCells(scratch.getFilledCells());
+  switch (status) {
+    case SOLVED:
+      solvedCount++;
+      return "OK " + cells;
+    case OUT_OF_BUDGET:
+      timeoutCount++;
+      return "TIMEOUT " + cells;
+    default:
+      failedCount++;
+      return "FAIL " + cells;
+  }
+}
+
+// Record latency of one answered job
+// arrival: time the job was read from the connection
+void Server::record(const CLOCK::time_point& arrival) {
+  auto latency = (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(CLOCK::now()-arrival).count();
+  totalLatency += latency;
+  auto max = maxLatency.load();
+  while (latency>max && !maxLatency.compare_exchange_weak(max, latency));
+  int bucket(0);
+  while (bucket<BUCKETS-1 && (1ul<<bucket)<=latency) ++bucket;
+  latencies[bucket]++;
+}
+
+// Latency percentile from the histogram
+// p: percentile in [0,1]
+// return: upper bound in microseconds of the bucket holding the percentile, at most the maximum
+unsigned long Server::percentile(const double& p) {
+  unsigned long count(0);
+  for (const auto& bucket : latencies) count += bucket.load();
+  if (count==0) return 0;
+  unsigned long seen(0);
+  for (int b = 0; b<BUCKETS; ++b) {
+    seen += latencies[b].load();
+    if (seen>=p*count) return std::min(1ul<<b, maxLatency.load());
+  }
+  return maxLatency.load();
+}
@@ -0,0 +1,112 @@
+//
+//  server.hpp
+//  SudokuSolver
+//
+//  Resident solver listening on a Unix socket. Each connection thread reads
+//  all pipelined request lines available and submits them as one batch; the
+//  solver threads pop jobs from a shared queue and reset their own Grid for
+//  each job instead of constructing a new one.
+//
+
+#ifndef server_hpp
+#define server_hpp
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include "grid.hpp"
+
+class Server {
+
+public:
+  // Solving method used by the solver threads
+  enum Method {HUMAN_STYLE, BRUT_FORCE};
+
+private:
+  // Request lines submitted together by one connection
+  struct Batch {
+    std::vector<std::string> responses;
+    int pending;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+  // Single puzzle waiting in the queue
+  struct Job {
+    FILLED_CELLS input;
+    Batch* batch;
+    size_t slot;
+    CLOCK::time_point arrival;
+  };
+  // Latency histogram size, bucket b counts latencies below 2^b microseconds
+  enum {BUCKETS = 32};
+
+  // Socket path
+  std::string path;
+  // Listening socket
+  int listenFd;
+  // Solving method
+  Method method;
+  // Unit tables of the puzzles
+  const Units* units;
+  // Search node budget and timeout per puzzle, 0 for unlimited
+  long maxNodes;
+  std::chrono::microseconds timeout;
+  // Maximum number of jobs popped by a solver thread at once
+  size_t batchSize;
+  // Solver threads
+  std::vector<std::thread> solvers;
+  // Pending jobs
+  std::deque<Job> queue;
+  std::mutex queueMutex;
+  std::condition_variable queueReady;
+  bool stopping;
+  // Open connections
+  std::set<int> connections;
+  std::mutex connectionsMutex;
+  std::condition_variable connectionsClosed;
+  // Running flag
+  std::atomic<bool> running;
+  // Statistics
+  CLOCK::time_point startTime;
+  std::atomic<unsigned long> solvedCount;
+  std::atomic<unsigned long> failedCount;
+  std::atomic<unsigned long> timeoutCount;
+  std::atomic<unsigned long> batchCount;
+  std::atomic<unsigned long> totalLatency;
+  std::atomic<unsigned long> maxLatency;
+  std::atomic<unsigned long> latencies[BUCKETS];
+
+public:
+  // Constructor
+  Server(const std::string& _path, const int& threads, const size_t& _batchSize, const Method& _method,
+         const long& _maxNodes = 0, const std::chrono::microseconds& _timeout = std::chrono::microseconds(0),
+         const Units& _units = CLASSIC_UNITS);
+  // Destructor
+  ~Server();
+  // Accept connections until stop() is called
+  bool run();
+  // Request run() to return, safe to call from a signal handler
+  void stop();
+  // Statistics line
+  std::string stats();
+
+private:
+  // Serve requests of one connection
+  void serve(const int fd);
+  // Solver thread loop
+  void solve();
+  // Solve one puzzle with the scratch grid of the solver thread
+  std::string solve(Grid& scratch, const FILLED_CELLS& input, const CLOCK::time_point& arrival);
+  // Record latency of one answered job
+  void record(const CLOCK::time_point& arrival);
+  // Latency percentile in microseconds from the histogram
+  unsigned long percentile(const double& p);
+};
+
+#endif /* server_hpp */